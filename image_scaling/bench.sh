@@ -0,0 +1,3 @@
+./image_scaler ../lenna.png 0.5 0.5 /tmp/bench_manual_scaled.png /tmp/bench_opencv_scaled.png bench
+./image_scaler ../lenna.png 1.5 1.5 /tmp/bench_manual_scaled.png /tmp/bench_opencv_scaled.png bench
+./image_scaler ../lenna.png 4.0 4.0 /tmp/bench_manual_scaled.png /tmp/bench_opencv_scaled.png bench
\ No newline at end of file
@@ -1 +1 @@
-g++ image_scaler.cpp -o image_scaler `pkg-config --cflags --libs opencv4`
\ No newline at end of file
+g++ -O3 image_scaler.cpp -o image_scaler `pkg-config --cflags --libs opencv4`
\ No newline at end of file
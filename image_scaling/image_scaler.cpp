@@ -36,14 +36,169 @@ Vec3b bilinear_interpolate(const Mat& src_image, double src_x, double src_y) {
     return interpolated_pixel;
 }
 
+/**
+ * @brief 像素填充的执行模式
+ */
+enum class SamplingMode {
+    Interleaved, // 交错模式：直接在BGR交错(Vec3b)的源图像上逐像素插值
+    Planar       // 平面模式：先拆分为单通道平面，逐平面插值，最后重新交错
+};
+
+/**
+ * @brief 解析命令行中的执行模式
+ * @param text 命令行参数 (interleaved 或 planar)
+ * @param mode 解析得到的执行模式 (引用传参)
+ * @return 参数合法时返回true
+ */
+bool parse_sampling_mode(const string& text, SamplingMode& mode) {
+    if (text == "interleaved") { mode = SamplingMode::Interleaved; return true; }
+    if (text == "planar")      { mode = SamplingMode::Planar;      return true; }
+    return false;
+}
+
+// 平面模式使用的定点插值权重位数 (Q11，与OpenCV的INTER_LINEAR相同)
+const int INTER_COEF_BITS = 11;
+const int INTER_COEF_SCALE = 1 << INTER_COEF_BITS;
+const int INTER_COEF_MASK = INTER_COEF_SCALE - 1;
+
+/**
+ * @brief 对单通道平面的一行做水平方向的定点插值
+ * @param src_row   源平面的一行
+ * @param x_floors  每个目标列对应的源整数x坐标
+ * @param x_alphas  每个目标列的Q11水平权重
+ * @param count     有效目标列的数量
+ * @param left      临时缓冲区，存放左侧像素
+ * @param right     临时缓冲区，存放右侧像素
+ * @param out       输出，Q11放大后的水平插值结果
+ */
+void interpolate_row_horizontal(const uchar* src_row, const int* x_floors, const int* x_alphas, int count,
+                                uchar* left, uchar* right, int* out) {
+    // 按下标取像素无法向量化，单独放在一个只做拷贝的循环里
+    for (int i = 0; i < count; ++i) {
+        left[i] = src_row[x_floors[i]];
+        right[i] = src_row[x_floors[i] + 1];
+    }
+    // 连续读写的定点运算，可以被编译器向量化
+    for (int i = 0; i < count; ++i) {
+        out[i] = left[i] * (INTER_COEF_SCALE - x_alphas[i]) + right[i] * x_alphas[i];
+    }
+}
+
+/**
+ * @brief 对两行水平插值结果做垂直方向的定点插值，两次Q11相乘后右移22位并四舍五入
+ * @param top     上方源行的水平插值结果
+ * @param bottom  下方源行的水平插值结果
+ * @param beta    Q11垂直权重
+ * @param count   有效目标列的数量
+ * @param out     输出的目标平面行
+ */
+void interpolate_row_vertical(const int* top, const int* bottom, int beta, int count, uchar* out) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<uchar>((top[i] * (INTER_COEF_SCALE - beta) + bottom[i] * beta
+                                     + (1 << (2 * INTER_COEF_BITS - 1))) >> (2 * INTER_COEF_BITS));
+    }
+}
+
+/**
+ * @brief 平面(SoA)模式的缩放像素填充
+ *
+ * 缩放的映射是可分离的：源x坐标只取决于目标列，源y坐标只取决于目标行。
+ * 1.  **列坐标**：x_src随目标列单调递增，有效列是前缀 [0, count)，其源整数坐标和Q11权重只计算一次。
+ * 2.  **逐平面插值**：源图像用cv::split拆分为单通道平面。每个平面先对所需的源行做水平插值 (相邻目标行共用时直接复用)，
+ *     再用连续读写的循环做垂直插值，结果写入该通道的行缓冲区。
+ * 3.  **重新交错**：三个通道的行缓冲区在写入目标行时直接交错，不需要整幅的目标平面和额外的cv::merge。
+ * 目标行按cv::getNumThreads()分成连续的块并行处理，块内的行缓存和缓冲区可以一直复用。
+ * 定点运算四舍五入，而交错模式是对double结果截断，因此两者的像素值可能相差1。
+ *
+ * @param src_image   源图像 (CV_8UC3)
+ * @param dest_image  已分配好并清零的目标图像 (CV_8UC3)
+ * @param scale_x     水平缩放比例
+ * @param scale_y     垂直缩放比例
+ */
+void fillPixelsPlanar(const Mat& src_image, Mat& dest_image, double scale_x, double scale_y) {
+    const int src_w = src_image.cols;
+    const int src_h = src_image.rows;
+    const int dest_w = dest_image.cols;
+    const int dest_h = dest_image.rows;
+
+    // 预先计算有效列的源坐标，乘以2的幂是精确的，截断即得到Q11定点坐标
+    vector<int> x_floors, x_alphas;
+    for (int x_dest = 0; x_dest < dest_w; ++x_dest) {
+        double x_src = x_dest / scale_x;
+        if (!(x_src < src_w - 1)) {
+            break;
+        }
+        int x_fixed = static_cast<int>(x_src * INTER_COEF_SCALE);
+        x_floors.push_back(x_fixed >> INTER_COEF_BITS);
+        x_alphas.push_back(x_fixed & INTER_COEF_MASK);
+    }
+    const int count = static_cast<int>(x_floors.size());
+
+    vector<Mat> planes;
+    split(src_image, planes);
+
+    parallel_for_(Range(0, dest_h), [&](const Range& range) {
+        vector<uchar> left(count), right(count);
+        vector<int> h_bufs[3][2];        // 每个通道缓存源行 cached_y 和 cached_y + 1 的水平插值结果
+        vector<uchar> row_bufs[3];       // 每个通道当前目标行的插值结果
+        int* top[3];
+        int* bottom[3];
+        for (int c = 0; c < 3; ++c) {
+            h_bufs[c][0].resize(count);
+            h_bufs[c][1].resize(count);
+            row_bufs[c].resize(count);
+            top[c] = h_bufs[c][0].data();
+            bottom[c] = h_bufs[c][1].data();
+        }
+
+        int cached_y = -2;
+        for (int y_dest = range.start; y_dest < range.end; ++y_dest) {
+            double y_src = y_dest / scale_y;
+            if (!(y_src < src_h - 1)) {
+                break;
+            }
+            int y_fixed = static_cast<int>(y_src * INTER_COEF_SCALE);
+            int y_floor = y_fixed >> INTER_COEF_BITS;
+            int beta = y_fixed & INTER_COEF_MASK;
+
+            for (int c = 0; c < 3; ++c) {
+                if (y_floor == cached_y + 1) {
+                    swap(top[c], bottom[c]);
+                    interpolate_row_horizontal(planes[c].ptr<uchar>(y_floor + 1), x_floors.data(), x_alphas.data(), count,
+                                               left.data(), right.data(), bottom[c]);
+                } else if (y_floor != cached_y) {
+                    interpolate_row_horizontal(planes[c].ptr<uchar>(y_floor), x_floors.data(), x_alphas.data(), count,
+                                               left.data(), right.data(), top[c]);
+                    interpolate_row_horizontal(planes[c].ptr<uchar>(y_floor + 1), x_floors.data(), x_alphas.data(), count,
+                                               left.data(), right.data(), bottom[c]);
+                }
+                interpolate_row_vertical(top[c], bottom[c], beta, count, row_bufs[c].data());
+            }
+            cached_y = y_floor;
+
+            // 三个通道的结果在写入目标行时重新交错为BGR
+            uchar* dest_row = dest_image.ptr<uchar>(y_dest);
+            const uchar* b = row_bufs[0].data();
+            const uchar* g = row_bufs[1].data();
+            const uchar* r = row_bufs[2].data();
+            for (int i = 0; i < count; ++i) {
+                dest_row[i * 3]     = b[i];
+                dest_row[i * 3 + 1] = g[i];
+                dest_row[i * 3 + 2] = r[i];
+            }
+        }
+    }, getNumThreads());
+}
+
 /**
  * @brief 【新接口】手动实现图像缩放
  * @param src_image 源图像
  * @param scale_x 水平缩放比例 (例如, 2.0代表放大一倍, 0.5代表缩小一半)
  * @param scale_y 垂直缩放比例
+ * @param mode 像素填充的执行模式，默认为Interleaved
  * @return 缩放后的图像
  */
-Mat scaleImageManually(const Mat& src_image, double scale_x, double scale_y) {
+Mat scaleImageManually(const Mat& src_image, double scale_x, double scale_y, SamplingMode mode = SamplingMode::Interleaved) {
     int src_w = src_image.cols;
     int src_h = src_image.rows;
 
@@ -54,6 +209,11 @@ Mat scaleImageManually(const Mat& src_image, double scale_x, double scale_y) {
     // 创建目标图像
     Mat dest_image = Mat::zeros(dest_h, dest_w, src_image.type());
 
+    if (mode == SamplingMode::Planar) {
+        fillPixelsPlanar(src_image, dest_image, scale_x, scale_y);
+        return dest_image;
+    }
+
     // 遍历目标图像的每一个像素 (反向映射)
     for (int y_dest = 0; y_dest < dest_h; ++y_dest) {
         for (int x_dest = 0; x_dest < dest_w; ++x_dest) {
@@ -87,10 +247,66 @@ Mat scaleImageWithOpenCV(const Mat& src_image, double scale_x, double scale_y) {
     return dest_image;
 }
 
+/**
+ * @brief 根据基准测试结果选择默认的执行模式
+ *
+ * 平面模式要先拆分整幅源图像，这部分开销只有在目标像素足够多时才能被摊薄。
+ * bench.sh 的单线程测试中，目标像素数不少于源像素数的一半时平面模式更快，明显缩小时交错模式更快。
+ *
+ * @param src_image 源图像
+ * @param scale_x 水平缩放比例
+ * @param scale_y 垂直缩放比例
+ * @return 默认使用的执行模式
+ */
+SamplingMode choose_sampling_mode(const Mat& src_image, double scale_x, double scale_y) {
+    int64 src_pixels = static_cast<int64>(src_image.cols) * src_image.rows;
+    int64 dest_pixels = static_cast<int64>(round(src_image.cols * scale_x)) * static_cast<int64>(round(src_image.rows * scale_y));
+    return dest_pixels * 2 >= src_pixels ? SamplingMode::Planar : SamplingMode::Interleaved;
+}
+
+/**
+ * @brief 在相同的线程数下比较交错模式和平面模式的耗时
+ *
+ * 交错模式是单线程实现，因此计时期间把OpenCV的线程数也限制为1，比较的只是数据布局本身。
+ * 每种模式重复repeats次并取最短耗时，最后输出两种模式结果的最大像素差。
+ *
+ * @param src_image 源图像
+ * @param scale_x 水平缩放比例
+ * @param scale_y 垂直缩放比例
+ * @param repeats 每种模式的重复次数
+ */
+void benchmarkSamplingModes(const Mat& src_image, double scale_x, double scale_y, int repeats = 5) {
+    const SamplingMode modes[2] = { SamplingMode::Interleaved, SamplingMode::Planar };
+    const char* mode_names[2] = { "interleaved", "planar" };
+    Mat results[2];
+    double best_ms[2];
+
+    int saved_threads = getNumThreads();
+    setNumThreads(1);
+    for (int m = 0; m < 2; ++m) {
+        best_ms[m] = -1;
+        for (int r = 0; r < repeats; ++r) {
+            int64 start_tick = getTickCount();
+            results[m] = scaleImageManually(src_image, scale_x, scale_y, modes[m]);
+            double elapsed_ms = (getTickCount() - start_tick) * 1000.0 / getTickFrequency();
+            if (best_ms[m] < 0 || elapsed_ms < best_ms[m]) {
+                best_ms[m] = elapsed_ms;
+            }
+        }
+    }
+    setNumThreads(saved_threads);
+
+    cout << "基准测试 (单线程, " << results[0].cols << "x" << results[0].rows << ", 取" << repeats << "次中的最短耗时):" << endl;
+    for (int m = 0; m < 2; ++m) {
+        cout << "  " << mode_names[m] << ": " << best_ms[m] << " ms" << endl;
+    }
+    cout << "  planar相对interleaved的加速比: " << best_ms[0] / best_ms[1] << endl;
+    cout << "  两种模式的最大像素差: " << norm(results[0], results[1], NORM_INF) << endl;
+}
 
 int main(int argc, char* argv[]) {
-    if (argc != 6) {
-        cerr << "用法: " << argv[0] << " <输入路径> <缩放x> <缩放y> <手动输出路径> <OpenCV输出路径>" << endl;
+    if (argc != 6 && argc != 7) {
+        cerr << "用法: " << argv[0] << " <输入路径> <缩放x> <缩放y> <手动输出路径> <OpenCV输出路径> [执行模式(interleaved/planar/bench)]" << endl;
         return -1;
     }
 
@@ -99,6 +315,15 @@ int main(int argc, char* argv[]) {
     double scale_y = stod(argv[3]);
     string manual_output_path = argv[4];
     string opencv_output_path = argv[5];
+
+    // 未指定执行模式时按基准测试结果自动选择；bench 会先比较两种模式的耗时，再按自动选择的模式输出图像
+    bool run_benchmark = argc == 7 && string(argv[6]) == "bench";
+    bool mode_given = argc == 7 && !run_benchmark;
+    SamplingMode mode = SamplingMode::Interleaved;
+    if (mode_given && !parse_sampling_mode(argv[6], mode)) {
+        cerr << "错误: 执行模式必须是 interleaved、planar 或 bench。" << endl;
+        return -1;
+    }
     
     Mat src_image = imread(input_path, IMREAD_COLOR);
     if (src_image.empty()) {
@@ -106,9 +331,19 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
+    if (!mode_given) {
+        mode = choose_sampling_mode(src_image, scale_x, scale_y);
+    }
+    if (run_benchmark) {
+        benchmarkSamplingModes(src_image, scale_x, scale_y);
+    }
+
     // --- 手动实现 ---
-    cout << "正在执行手动实现的图像缩放..." << endl;
-    Mat manual_scaled_image = scaleImageManually(src_image, scale_x, scale_y);
+    cout << "正在执行手动实现的图像缩放 (" << (mode == SamplingMode::Planar ? "planar" : "interleaved") << ")..." << endl;
+    int64 start_tick = getTickCount();
+    Mat manual_scaled_image = scaleImageManually(src_image, scale_x, scale_y, mode);
+    double elapsed_ms = (getTickCount() - start_tick) * 1000.0 / getTickFrequency();
+    cout << "手动缩放耗时: " << elapsed_ms << " ms" << endl;
     imwrite(manual_output_path, manual_scaled_image);
     cout << "手动缩放的图像已保存到: " << manual_output_path << endl;
 